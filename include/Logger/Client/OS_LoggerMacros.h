@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @file
+ * @brief Logging macros with compile-time level elimination.
+ *
+ * Set OS_Logger_CONFIG_COMPILE_LEVEL in the file given by
+ * OS_Logger_CONFIG_H_FILE to the highest level that shall be compiled in.
+ * Calls with a higher level compile to nothing, their arguments are never
+ * evaluated. Calls with a lower or equal level first check the emitter's
+ * filter and evaluate the arguments only if the entry will be emitted.
+ */
+#pragma once
+
+#include "Logger/Client/OS_LoggerEmitter.h"
+
+#if defined(OS_Logger_CONFIG_H_FILE)
+#define OS_Logger_XSTR(d)   OS_Logger_STR(d)
+#define OS_Logger_STR(d)    #d
+#include OS_Logger_XSTR(OS_Logger_CONFIG_H_FILE)
+#endif
+
+// same values as in lib_debug
+#if !defined(Debug_LOG_LEVEL_NONE)
+#define Debug_LOG_LEVEL_NONE        0
+#define Debug_LOG_LEVEL_ASSERT      1
+#define Debug_LOG_LEVEL_FATAL       2
+#define Debug_LOG_LEVEL_ERROR       3
+#define Debug_LOG_LEVEL_WARNING     4
+#define Debug_LOG_LEVEL_INFO        5
+#define Debug_LOG_LEVEL_DEBUG       6
+#define Debug_LOG_LEVEL_TRACE       7
+#endif
+
+#if !defined(OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_CONFIG_COMPILE_LEVEL  Debug_LOG_LEVEL_TRACE
+#endif
+
+/**
+ * @brief Checks if an entry of the given level would pass the filter of the
+ *        default emitter instance.
+ *
+ * @param logLevel level of the entry
+ *
+ * @return true if the emitter exists and the entry is not filtered out
+ */
+bool
+OS_LoggerEmitter_isEnabled(uint8_t logLevel);
+
+/**
+ * Logs with a level that is a compile-time constant. The level check is
+ * folded by the compiler, the filter check happens before the arguments are
+ * evaluated.
+ */
+#define OS_Logger_LOG(level, ...) \
+    do \
+    { \
+        if (((level) <= OS_Logger_CONFIG_COMPILE_LEVEL) \
+            && OS_LoggerEmitter_isEnabled(level)) \
+        { \
+            (void)OS_LoggerEmitter_log((level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+/**
+ * Logs a string literal without going through the format string parser.
+ */
+#define OS_Logger_LOG_CONST(level, str) \
+    do \
+    { \
+        if (((level) <= OS_Logger_CONFIG_COMPILE_LEVEL) \
+            && OS_LoggerEmitter_isEnabled(level)) \
+        { \
+            (void)OS_LoggerEmitter_logString( \
+                (level), "" str "", sizeof(str) - 1); \
+        } \
+    } while (0)
+
+#define OS_Logger_DISCARD(...)  do { } while (0)
+
+#if (Debug_LOG_LEVEL_ASSERT <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_ASSERT(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_ASSERT, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_ASSERT(...)   OS_Logger_DISCARD(__VA_ARGS__)
+#endif
+
+#if (Debug_LOG_LEVEL_FATAL <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_FATAL(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_FATAL, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_FATAL(...)    OS_Logger_DISCARD(__VA_ARGS__)
+#endif
+
+#if (Debug_LOG_LEVEL_ERROR <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_ERROR(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_ERROR(...)    OS_Logger_DISCARD(__VA_ARGS__)
+#endif
+
+#if (Debug_LOG_LEVEL_WARNING <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_WARNING(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_WARNING(...)  OS_Logger_DISCARD(__VA_ARGS__)
+#endif
+
+#if (Debug_LOG_LEVEL_INFO <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_INFO(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_INFO(...)     OS_Logger_DISCARD(__VA_ARGS__)
+#endif
+
+#if (Debug_LOG_LEVEL_DEBUG <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_DEBUG(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_DEBUG(...)    OS_Logger_DISCARD(__VA_ARGS__)
+#endif
+
+#if (Debug_LOG_LEVEL_TRACE <= OS_Logger_CONFIG_COMPILE_LEVEL)
+#define OS_Logger_LOG_TRACE(...) \
+    OS_Logger_LOG(Debug_LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define OS_Logger_LOG_TRACE(...)    OS_Logger_DISCARD(__VA_ARGS__)
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @file
+ * @brief Log query predicate shared by the log client and the log server.
+ *
+ * A client places an OS_LoggerQuery_t in the message field of the log entry
+ * in its dataport and calls `API_LOG_SERVER_QUERY_LOG_FILE`. The server
+ * evaluates the predicate while streaming the log file and copies back only
+ * the matching lines to the same place.
+ *
+ * The predicate is evaluated against lines written in the layout of the
+ * default OS_LoggerFormat.
+ */
+#pragma once
+
+#include "Logger/Common/OS_LoggerSymbols.h"
+#include "Logger/Common/OS_LoggerEntry.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(OS_Logger_QUERY_PATTERN_LENGTH)
+#define OS_Logger_QUERY_PATTERN_LENGTH  64
+#endif
+
+/** Match only lines of the given consumer id. */
+#define OS_LoggerQuery_MATCH_CONSUMER_ID    (1u << 0)
+/** Match only lines with a timestamp >= timestamp_from. */
+#define OS_LoggerQuery_MATCH_TIME_FROM      (1u << 1)
+/** Match only lines with a timestamp <= timestamp_to. */
+#define OS_LoggerQuery_MATCH_TIME_TO        (1u << 2)
+/** Match only lines whose message contains the pattern. */
+#define OS_LoggerQuery_MATCH_PATTERN        (1u << 3)
+
+typedef struct
+{
+    uint32_t    flags;
+    uint32_t    consumer_id;
+    uint64_t    timestamp_from;
+    uint64_t    timestamp_to;
+    uint32_t    pattern_len;
+    char        pattern[OS_Logger_QUERY_PATTERN_LENGTH + 1];
+} OS_LoggerQuery_t;
+
+/**
+ * @brief Initializes a query that matches every line.
+ *
+ * @param self (required) pointer to the query
+ */
+void
+OS_LoggerQuery_ctor(OS_LoggerQuery_t* self);
+
+/**
+ * @brief Sets the message substring the query is looking for.
+ *
+ * @param self      (required) pointer to the query
+ * @param pattern   (required) null-terminated substring
+ *
+ * @return an error code
+ * @retval OS_SUCCESS                   if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER   if pattern is NULL, empty or longer
+ *                                      than OS_Logger_QUERY_PATTERN_LENGTH
+ */
+OS_Error_t
+OS_LoggerQuery_setPattern(OS_LoggerQuery_t* self, const char* pattern);
+
+/**
+ * @brief Evaluates the query against one formatted log line.
+ *
+ * @param self  (required) pointer to the query
+ * @param line  (required) pointer to the line, not necessarily terminated
+ * @param len   length of the line without the trailing newline
+ *
+ * @return true if the line satisfies all predicates of the query
+ */
+bool
+OS_LoggerQuery_matchLine(
+    const OS_LoggerQuery_t* self,
+    const char* line,
+    size_t len);
+
+/**
+ * @brief Evaluates the query against a log entry.
+ *
+ * @param self  (required) pointer to the query
+ * @param entry (required) pointer to the log entry
+ *
+ * @return true if the entry satisfies all predicates of the query
+ */
+bool
+OS_LoggerQuery_matchEntry(
+    const OS_LoggerQuery_t* self,
+    OS_LoggerEntry_t const* entry);
+
+/**
+ * @brief Decodes one formatted log line back into a log entry.
+ *
+ * The level of the entry itself is not part of the line, it is left 0.
+ *
+ * @param line  (required) pointer to the line, not necessarily terminated
+ * @param len   length of the line without the trailing newline
+ * @param entry (required) entry to fill
+ *
+ * @return an error code
+ * @retval OS_SUCCESS                   if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER   if the line can't be decoded
+ */
+OS_Error_t
+OS_LoggerQuery_parseLine(
+    const char* line,
+    size_t len,
+    OS_LoggerEntry_t* entry);
+
+/**
+ * @brief Finds the first occurrence of needle in haystack.
+ *
+ * The scan is driven by memchr() on the first needle byte, which the C
+ * library implements with word-wise/vector loads on our targets.
+ *
+ * @return pointer to the first occurrence or NULL
+ */
+const char*
+OS_LoggerQuery_findSubstring(
+    const char* haystack,
+    size_t haystack_len,
+    const char* needle,
+    size_t needle_len);
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @file
+ * @brief Sparse timestamp index kept next to a log file.
+ *
+ * For every log file "name" a sidecar file "name.idx" is maintained. It holds
+ * one OS_LoggerFileIndex_Record_t for the first line written in each
+ * OS_Logger_FILE_INDEX_STRIDE bytes of the log file, so a time window can be
+ * located with a binary search instead of a linear read of the log.
+ */
+#pragma once
+
+#include "Logger/Server/OS_LoggerFile.h"
+
+#include <stdint.h>
+
+#if !defined(OS_Logger_FILE_INDEX_STRIDE)
+#define OS_Logger_FILE_INDEX_STRIDE     4096
+#endif
+
+#define OS_Logger_FILE_INDEX_SUFFIX     ".idx"
+
+typedef struct
+{
+    uint64_t timestamp;
+    uint64_t offset;
+} OS_LoggerFileIndex_Record_t;
+
+/**
+ * @brief Removes the index of a log file.
+ *
+ * @param log_file (required) pointer to the log file handle
+ *
+ * @return an error code
+ */
+OS_Error_t
+OS_LoggerFileIndex_reset(OS_LoggerFile_Handle_t* log_file);
+
+/**
+ * @brief Records a line written to the log file, if it is the first line in a
+ *        new index stride.
+ *
+ * @param log_file  (required) pointer to the log file handle
+ * @param offset    offset at which the line was written
+ * @param len       length of the line
+ * @param timestamp timestamp of the log entry
+ *
+ * @return an error code
+ */
+OS_Error_t
+OS_LoggerFileIndex_update(
+    OS_LoggerFile_Handle_t* log_file,
+    uint64_t offset,
+    uint64_t len,
+    uint64_t timestamp);
+
+/**
+ * @brief Finds the offset to start reading from for entries with a timestamp
+ *        greater or equal to the given one.
+ *
+ * @param log_file  (required) pointer to the log file handle
+ * @param timestamp timestamp to look for
+ * @param offset    (required) offset of the line to start reading from, 0 if
+ *                  the index doesn't contain any earlier line
+ *
+ * @return an error code
+ */
+OS_Error_t
+OS_LoggerFileIndex_seek(
+    OS_LoggerFile_Handle_t* log_file,
+    uint64_t timestamp,
+    uint64_t* offset);
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @file
+ * @brief Rendering of log entries into caller-provided memory.
+ *
+ * Unlike OS_LoggerAbstractFormat_vtable_t::convert, which renders into the
+ * scratch buffer of the format, a render function writes straight into the
+ * given destination, e.g. a slot of an output's batch buffer.
+ */
+#pragma once
+
+#include "Logger/Common/OS_LoggerEntry.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Renders a log entry as one line.
+ *
+ * @param entry (required) pointer to the log entry
+ * @param buf   (required) destination buffer
+ * @param size  size of the destination buffer
+ *
+ * @return length the complete line has, without the null-terminator. If it is
+ *         greater or equal to size, the line in buf got truncated.
+ */
+typedef size_t (*OS_LoggerFormatRender_t)(
+    OS_LoggerEntry_t const* const entry,
+    char* buf,
+    size_t size);
+
+/**
+ * @brief Renders a log entry in the layout of the default OS_LoggerFormat.
+ *
+ * @see OS_LoggerFormatRender_t
+ */
+size_t
+OS_LoggerFormatRender_default(
+    OS_LoggerEntry_t const* const entry,
+    char* buf,
+    size_t size);
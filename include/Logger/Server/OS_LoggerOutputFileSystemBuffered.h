@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @file
+ * @brief Buffered file system output with a critical and a bulk lane.
+ *
+ * Entries with a level up to the critical level (e.g. errors) are written to
+ * the log file immediately, together with everything that is still pending.
+ * All other entries (e.g. info and debug) are collected in a buffer and only
+ * written when the buffer is full, an entry for another log file arrives, the
+ * durability policy asks for it or OS_LoggerOutputFileSystemBuffered_flush()
+ * is called, which the log server is supposed to do when it is idle.
+ *
+ * With a render function set, entries are rendered straight into the buffer
+ * and all pending entries are written with a single write call, instead of
+ * being converted into the format's buffer and copied from there.
+ *
+ * The handle embeds an OS_LoggerOutput_Handle_t as its first member, so it
+ * can be attached to a subject like any other output.
+ */
+#pragma once
+
+#include "Logger/Server/OS_LoggerOutput.h"
+#include "Logger/Server/OS_LoggerFile.h"
+#include "Logger/Server/OS_LoggerFormatRender.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Debug_LOG_LEVEL_ERROR
+#if !defined(OS_Logger_LANE_CRITICAL_LEVEL)
+#define OS_Logger_LANE_CRITICAL_LEVEL   3
+#endif
+
+/**
+ * Durability policy, i.e. when pending entries are synced to the log file.
+ * Independent of the policy, entries are synced whenever the buffer is full.
+ * A policy with all members set to 0 never syncs otherwise, which gives the
+ * highest throughput.
+ */
+typedef struct
+{
+    /** sync on entries with a level less or equal, 0 to disable */
+    uint8_t     sync_level;
+    /** sync once that many entries are pending, 0 to disable */
+    uint32_t    sync_entries;
+    /** sync once the oldest pending entry is that many seconds older than
+        the newest one, 0 to disable */
+    uint32_t    sync_interval;
+} OS_LoggerDurability_t;
+
+typedef struct
+{
+    OS_LoggerOutput_Handle_t    output;
+    OS_LoggerFile_Handle_t*     log_file;
+    char*                       buffer;
+    size_t                      size;
+    size_t                      used;
+    OS_LoggerDurability_t       durability;
+    uint32_t                    pending_entries;
+    uint64_t                    pending_since;
+    uint32_t                    sync_count;
+    OS_LoggerFormatRender_t     render;
+} OS_LoggerOutputFileSystemBuffered_Handle_t;
+
+/**
+ * @brief Constructor.
+ *
+ * @param self              (required) pointer to the output
+ * @param logFormat         (required) pointer to the log format
+ * @param buffer            (required) buffer for the bulk lane
+ * @param size              size of the buffer
+ * @param critical_level    entries with a level less or equal to this one
+ *                          are written immediately, this is the sync_level
+ *                          of the initial durability policy
+ *
+ * @return an error code
+ * @retval OS_SUCCESS                   if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER   if a parameter is invalid
+ */
+OS_Error_t
+OS_LoggerOutputFileSystemBuffered_ctor(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self,
+    OS_LoggerFormat_Handle_t* logFormat,
+    void* buffer,
+    size_t size,
+    uint8_t critical_level);
+
+/**
+ * @brief Sets the durability policy of the output.
+ *
+ * @param self          (required) pointer to the output
+ * @param durability    (required) pointer to the policy, it is copied
+ */
+void
+OS_LoggerOutputFileSystemBuffered_setDurability(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self,
+    OS_LoggerDurability_t const* durability);
+
+/**
+ * @brief Returns how often pending entries have been synced to the log file.
+ *
+ * @param self (required) pointer to the output
+ */
+uint32_t
+OS_LoggerOutputFileSystemBuffered_getSyncCount(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self);
+
+/**
+ * @brief Sets the function rendering entries straight into the buffer.
+ *
+ * The render function has to produce the same layout as the log format of
+ * the output, e.g. OS_LoggerFormatRender_default() for OS_LoggerFormat.
+ *
+ * @param self      (required) pointer to the output
+ * @param render    render function, NULL to use the log format's convert()
+ */
+void
+OS_LoggerOutputFileSystemBuffered_setRender(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self,
+    OS_LoggerFormatRender_t render);
+
+/**
+ * @brief Writes all pending entries of the bulk lane to the log file.
+ *
+ * @param self (required) pointer to the output
+ *
+ * @return an error code
+ */
+OS_Error_t
+OS_LoggerOutputFileSystemBuffered_flush(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self);
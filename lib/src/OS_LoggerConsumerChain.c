@@ -18,10 +18,22 @@ static const OS_LoggerConsumerChain_vtable_t Consumer_chain_vtable =
 };
 
 
+#if !defined(OS_Logger_CONSUMER_CHAIN_MAX_CONSUMERS)
+#define OS_Logger_CONSUMER_CHAIN_MAX_CONSUMERS  64
+#endif
+
 // Singleton
 static OS_LoggerConsumerChain_Handle_t _consumer_chain;
 static OS_LoggerConsumerChain_Handle_t* this = NULL;
 
+// Contiguous copy of the chain used for lookups. The linked list is still
+// maintained for code walking the chain via "node.first".
+static OS_LoggerConsumer_Handle_t*
+_consumers[OS_Logger_CONSUMER_CHAIN_MAX_CONSUMERS];
+static uint32_t _consumer_ids[OS_Logger_CONSUMER_CHAIN_MAX_CONSUMERS];
+static size_t _consumers_count = 0;
+static OS_LoggerConsumer_Handle_t* _last = NULL;
+
 
 
 OS_LoggerConsumerChain_Handle_t*
@@ -46,16 +58,26 @@ OS_LoggerConsumerChain_append(OS_LoggerConsumer_Handle_t* consumer)
         return OS_ERROR_INVALID_PARAMETER;
     }
 
+    if (_consumers_count >= OS_Logger_CONSUMER_CHAIN_MAX_CONSUMERS)
+    {
+        return OS_ERROR_INSUFFICIENT_SPACE;
+    }
+
     if (this->node.first == NULL)
     {
         this->node.first = consumer;
-        return OS_SUCCESS;
+    }
+    else
+    {
+        // the last consumer of the list is known, no need to walk there
+        OS_LoggerListT_insert(&_last->node, &consumer->node);
     }
 
-    OS_LoggerListT_insert(
-        OS_LoggerListT_getLast(
-            &(((OS_LoggerConsumer_Handle_t*)(this->node.first))->node)),
-        &consumer->node);
+    _last = consumer;
+
+    _consumers[_consumers_count] = consumer;
+    _consumer_ids[_consumers_count] = consumer->entry->consumerMetadata.id;
+    _consumers_count++;
 
     return OS_SUCCESS;
 }
@@ -72,6 +94,28 @@ OS_LoggerConsumerChain_remove(OS_LoggerConsumer_Handle_t* consumer)
         return OS_ERROR_INVALID_PARAMETER;
     }
 
+    size_t i = 0;
+
+    while (i < _consumers_count && _consumers[i] != consumer)
+    {
+        i++;
+    }
+
+    if (i == _consumers_count)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    // swap-remove, the lookup doesn't depend on the order
+    _consumers_count--;
+    _consumers[i] = _consumers[_consumers_count];
+    _consumer_ids[i] = _consumer_ids[_consumers_count];
+
+    if (_last == consumer)
+    {
+        _last = OS_LoggerListT_getPrevious(&consumer->node);
+    }
+
     if (this->node.first == consumer)
     {
         this->node.first = OS_LoggerListT_getNext(&consumer->node);
@@ -93,26 +137,25 @@ OS_LoggerConsumerChain_getSender(void)
 {
     OS_Logger_CHECK_SELF(this);
 
-    OS_LoggerConsumer_Handle_t* log_consumer;
+    OS_LoggerConsumerCallback_getSenderId_t get_sender_id = NULL;
+    uint32_t sender_id = 0;
 
-    if (this->node.first == NULL)
+    for (size_t i = 0; i < _consumers_count; i++)
     {
-        return NULL;
-    }
+        OS_LoggerConsumer_Handle_t* const log_consumer = _consumers[i];
 
-    log_consumer = this->node.first;
+        // consumers usually share the callback, ask only once per callback
+        if (get_sender_id != log_consumer->callback_vtable->get_sender_id)
+        {
+            get_sender_id = log_consumer->callback_vtable->get_sender_id;
+            sender_id = get_sender_id();
+        }
 
-    do
-    {
-        if (log_consumer->entry->consumerMetadata.id
-            == log_consumer->callback_vtable->get_sender_id())
+        if (_consumer_ids[i] == sender_id)
         {
             return log_consumer;
-            break;
         }
     }
-    while ((log_consumer = OS_LoggerListT_getNext(
-                               &log_consumer->node)) != NULL);
 
     return NULL;
 }
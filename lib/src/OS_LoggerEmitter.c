@@ -7,10 +7,16 @@
  */
 
 #include "Logger/Client/OS_LoggerEmitter.h"
+#include "Logger/Client/OS_LoggerMacros.h"
 #include "Logger/Common/OS_LoggerEntry.h"
 #include "Logger/Common/OS_LoggerSymbols.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdarg.h>
+
+#if !defined(OS_Logger_EMITTER_MAX_INSTANCES)
+#define OS_Logger_EMITTER_MAX_INSTANCES     4
+#endif
 
 typedef void* (*OS_LoggerEmitter_getBuffer_t)(void);
 
@@ -25,6 +31,27 @@ struct OS_LoggerEmitter_Handle
 static OS_LoggerEmitter_Handle_t _log_emitter;
 static OS_LoggerEmitter_Handle_t* this = NULL;
 
+// Additional instances, e.g. for separate audit and debug channels
+static OS_LoggerEmitter_Handle_t _log_emitters[OS_Logger_EMITTER_MAX_INSTANCES];
+static size_t _log_emitters_count = 0;
+
+// forward declaration
+static bool _isFilteredOut(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel);
+
+static OS_Error_t _log(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel,
+    const char* format,
+    va_list args);
+
+static OS_Error_t _logString(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel,
+    const char* msg,
+    size_t len);
+
 OS_LoggerEmitter_Handle_t*
 OS_LoggerEmitter_getInstance(
     void* buffer,
@@ -53,58 +80,193 @@ OS_LoggerEmitter_getInstance(
     return this;
 }
 
-OS_Error_t
-OS_LoggerEmitter_log(uint8_t logLevel, const char* format, ...)
+OS_LoggerEmitter_Handle_t*
+OS_LoggerEmitter_createInstance(
+    void* buffer,
+    OS_LoggerFilter_Handle_t* log_filter,
+    event_notify_func_t       emit)
+{
+    if (buffer == NULL || emit == NULL)
+    {
+        return NULL;
+    }
+
+    if (_log_emitters_count >= OS_Logger_EMITTER_MAX_INSTANCES)
+    {
+        return NULL;
+    }
+
+    OS_LoggerEmitter_Handle_t* self = &_log_emitters[_log_emitters_count++];
+
+    self->entry = (OS_LoggerEntry_t*)buffer;
+    self->log_filter = log_filter;
+    self->emit = emit;
+
+    return self;
+}
+
+bool
+OS_LoggerEmitter_isEnabled(uint8_t logLevel)
 {
     if (NULL == this)
     {
-        return OS_ERROR_INVALID_HANDLE;
+        return false;
     }
 
-    if (NULL == format)
+    if (this->log_filter == NULL)
     {
-        return OS_ERROR_INVALID_PARAMETER;
+        return true;
     }
 
-    if (this->log_filter != NULL)
+    return !this->log_filter->vtable->isFilteredOut(this->log_filter, logLevel);
+}
+
+OS_Error_t
+OS_LoggerEmitter_log(uint8_t logLevel, const char* format, ...)
+{
+    va_list args;
+    va_start (args, format);
+
+    const OS_Error_t err = _log(this, logLevel, format, args);
+
+    va_end (args);
+
+    return err;
+}
+
+OS_Error_t
+OS_LoggerEmitter_logTo(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel,
+    const char* format,
+    ...)
+{
+    va_list args;
+    va_start (args, format);
+
+    const OS_Error_t err = _log(self, logLevel, format, args);
+
+    va_end (args);
+
+    return err;
+}
+
+OS_Error_t
+OS_LoggerEmitter_logString(uint8_t logLevel, const char* msg, size_t len)
+{
+    return _logString(this, logLevel, msg, len);
+}
+
+OS_Error_t
+OS_LoggerEmitter_logStringTo(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel,
+    const char* msg,
+    size_t len)
+{
+    return _logString(self, logLevel, msg, len);
+}
+
+static bool
+_isFilteredOut(OS_LoggerEmitter_Handle_t* self, uint8_t logLevel)
+{
+    if (self->log_filter != NULL)
     {
-        this->entry->emitterMetadata.filteringLevel
-            = this->log_filter->log_level;
+        self->entry->emitterMetadata.filteringLevel
+            = self->log_filter->log_level;
 
-        if (this->log_filter->vtable->isFilteredOut(
-                this->log_filter,
+        if (self->log_filter->vtable->isFilteredOut(
+                self->log_filter,
                 logLevel))
         {
-            return OS_SUCCESS;
+            return true;
         }
     }
     else
     {
-        this->entry->emitterMetadata.filteringLevel = 0U;
+        self->entry->emitterMetadata.filteringLevel = 0U;
     }
 
-    this->entry->emitterMetadata.level = logLevel;
+    self->entry->emitterMetadata.level = logLevel;
 
-    va_list args;
-    va_start (args, format);
+    return false;
+}
+
+static OS_Error_t
+_logString(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel,
+    const char* msg,
+    size_t len)
+{
+    if (NULL == self)
+    {
+        return OS_ERROR_INVALID_HANDLE;
+    }
+
+    if (NULL == msg)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    if (_isFilteredOut(self, logLevel))
+    {
+        return OS_SUCCESS;
+    }
+
+    // The message is taken as it is, there is no format string to parse. Like
+    // with formatted entries, messages exceeding the maximum allowed length
+    // are truncated and the result is null-terminated.
+    if (len >= sizeof(self->entry->msg))
+    {
+        len = sizeof(self->entry->msg) - 1;
+    }
+
+    memcpy(self->entry->msg, msg, len);
+    self->entry->msg[len] = '\0';
+
+    self->emit();
+
+    return OS_SUCCESS;
+}
+
+static OS_Error_t
+_log(
+    OS_LoggerEmitter_Handle_t* self,
+    uint8_t logLevel,
+    const char* format,
+    va_list args)
+{
+    if (NULL == self)
+    {
+        return OS_ERROR_INVALID_HANDLE;
+    }
+
+    if (NULL == format)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    if (_isFilteredOut(self, logLevel))
+    {
+        return OS_SUCCESS;
+    }
 
     // Log message entries that exceed the maximum allowed length will be
     // truncated. It is ensured that the resulting string in the buffer will be
     // null-terminated.
     const int retval = vsnprintf(
-                           this->entry->msg,
-                           sizeof(this->entry->msg),
+                           self->entry->msg,
+                           sizeof(self->entry->msg),
                            format,
                            args);
 
-    va_end (args);
-
     if (retval < 0)
     {
         return OS_ERROR_GENERIC;
     }
 
-    this->emit();
+    self->emit();
 
     return OS_SUCCESS;
 }
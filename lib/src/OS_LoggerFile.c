@@ -9,6 +9,8 @@
 #include "Logger/Server/OS_LoggerFile.h"
 #include "Logger/Server/OS_LoggerConsumerChain.h"
 #include "Logger/Server/OS_LoggerConsumer.h"
+#include "Logger/Server/OS_LoggerFileIndex.h"
+#include "Logger/Common/OS_LoggerQuery.h"
 #include <string.h>
 #include <stdio.h>
 #include <inttypes.h>
@@ -23,6 +25,18 @@ static int64_t _Log_file_read_log_file(
 
 static void* _Log_file_get_consumer_by_filename(const char* filename);
 
+#if !defined(OS_Logger_QUERY_CHUNK_SIZE)
+#define OS_Logger_QUERY_CHUNK_SIZE  DATABUFFER_SIZE
+#endif
+
+// bytes at the end of a log file that are searched for a torn last line
+#if !defined(OS_Logger_FILE_RECOVERY_WINDOW)
+#define OS_Logger_FILE_RECOVERY_WINDOW  DATABUFFER_SIZE
+#endif
+
+// scratch buffer log files are streamed through, e.g. to evaluate a query
+static char file_chunk[OS_Logger_QUERY_CHUNK_SIZE];
+
 static const OS_LoggerFile_vtable_t Log_file_vtable =
 {
     .dtor                     = OS_LoggerFile_dtor,
@@ -192,6 +206,245 @@ API_LOG_SERVER_READ_LOG_FILE(
 
 
 
+int64_t
+API_LOG_SERVER_SEEK_LOG_FILE(
+    const char* filename,
+    uint64_t timestamp)
+{
+    if (filename == NULL)
+    {
+        return -1;
+    }
+
+    OS_LoggerConsumer_Handle_t* log_consumer_filename =
+        (OS_LoggerConsumer_Handle_t*)_Log_file_get_consumer_by_filename(
+            filename);
+
+    if (log_consumer_filename == NULL)
+    {
+        return -1;
+    }
+
+    uint64_t offset;
+    OS_Error_t err = OS_LoggerFileIndex_seek(
+                         (OS_LoggerFile_Handle_t*)log_consumer_filename->log_file,
+                         timestamp,
+                         &offset);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to seek in file: %s\n", __func__, filename);
+        return -1;
+    }
+
+    return (int64_t)offset;
+}
+
+
+
+int64_t
+API_LOG_SERVER_QUERY_LOG_FILE(
+    const char* filename,
+    uint64_t offset,
+    uint64_t len,
+    int64_t* log_file_size,
+    int64_t* next_offset)
+{
+    if (filename == NULL || log_file_size == NULL || next_offset == NULL)
+    {
+        return -1;
+    }
+
+    OS_LoggerConsumer_Handle_t* log_consumer =
+        OS_LoggerConsumerChain_getSender();
+
+    if (log_consumer == NULL)
+    {
+        return -1;
+    }
+
+    OS_LoggerConsumer_Handle_t* log_consumer_filename =
+        (OS_LoggerConsumer_Handle_t*)_Log_file_get_consumer_by_filename(
+            filename);
+
+    if (log_consumer_filename == NULL)
+    {
+        return -1;
+    }
+
+    // the client has placed the query in the message of its entry, take a
+    // copy before it gets overwritten with the matching lines. The metadata of
+    // the entry is left untouched, it identifies the sender.
+    OS_LoggerQuery_t query;
+    memcpy(&query, log_consumer->entry->msg, sizeof(query));
+
+    if (query.pattern_len > OS_Logger_QUERY_PATTERN_LENGTH)
+    {
+        return -1;
+    }
+
+    if (len > sizeof(log_consumer->entry->msg))
+    {
+        len = sizeof(log_consumer->entry->msg);
+    }
+
+    OS_LoggerFile_Handle_t* logFile = (OS_LoggerFile_Handle_t*)
+                                      log_consumer_filename->log_file;
+
+    // skip the part of the file that is known to be older than the query
+    if (query.flags & OS_LoggerQuery_MATCH_TIME_FROM)
+    {
+        uint64_t index_offset;
+
+        if ((OS_LoggerFileIndex_seek(logFile, query.timestamp_from,
+                                     &index_offset) == OS_SUCCESS)
+            && (index_offset > offset))
+        {
+            offset = index_offset;
+        }
+    }
+
+    off_t sz;
+    OS_Error_t err = OS_FileSystemFile_getSize(logFile->log_file_info.hFs,
+                                               filename, &sz);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to get size of file: %s\n",
+               __func__,
+               filename);
+        return -1;
+    }
+
+    *log_file_size = sz;
+
+    logFile->log_file_info.length = (uint64_t) (*log_file_size);
+    if (offset > (uint64_t)sz)
+    {
+        printf(
+            "%s(): ERROR offset %"PRIu64" greater file size %" PRIiMAX " for: %s\n",
+            __func__,
+            offset,
+            sz,
+            filename);
+
+        return -1;
+    }
+
+    OS_FileSystemFile_Handle_t hFile;
+    err = OS_FileSystemFile_open(logFile->log_file_info.hFs,
+                                 &hFile,
+                                 filename,
+                                 OS_FileSystem_OpenMode_RDONLY,
+                                 OS_FileSystem_OpenFlags_NONE);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to open file: %s\n", __func__, filename);
+        return -1;
+    }
+
+    char* const dest = log_consumer->entry->msg;
+    uint64_t written = 0;
+    uint64_t pos = offset;
+    bool skip_to_newline = false;
+    bool dest_full = false;
+
+    while (!dest_full && pos < (uint64_t)sz)
+    {
+        size_t chunk = sizeof(file_chunk);
+        if ((uint64_t)sz - pos < chunk)
+        {
+            chunk = (size_t)((uint64_t)sz - pos);
+        }
+
+        err = OS_FileSystemFile_read(logFile->log_file_info.hFs,
+                                     hFile,
+                                     (size_t)pos,
+                                     chunk,
+                                     file_chunk);
+        if (OS_SUCCESS != err)
+        {
+            printf("%s(): ERROR: failed to read file: %s\n", __func__, filename);
+            OS_FileSystemFile_close(logFile->log_file_info.hFs, hFile);
+            return -1;
+        }
+
+        const bool is_last_chunk = ((pos + chunk) == (uint64_t)sz);
+        size_t consumed = 0;
+
+        while (consumed < chunk)
+        {
+            const char* line = &file_chunk[consumed];
+            const char* nl = memchr(line, '\n', chunk - consumed);
+            size_t line_len;
+
+            if (nl != NULL)
+            {
+                line_len = (size_t)(nl - line);
+            }
+            else if (is_last_chunk)
+            {
+                // torn last line without a newline
+                line_len = chunk - consumed;
+            }
+            else
+            {
+                break;
+            }
+
+            const size_t line_size = (nl != NULL) ? line_len + 1 : line_len;
+
+            if (skip_to_newline)
+            {
+                skip_to_newline = false;
+            }
+            else if (OS_LoggerQuery_matchLine(&query, line, line_len))
+            {
+                if (written + line_size > len)
+                {
+                    if (written > 0)
+                    {
+                        dest_full = true;
+                        break;
+                    }
+
+                    // the line can never fit into the client's buffer, drop
+                    // it instead of stalling the query
+                    consumed += line_size;
+                    continue;
+                }
+
+                memcpy(&dest[written], line, line_size);
+                written += line_size;
+            }
+
+            consumed += line_size;
+        }
+
+        if (consumed == 0 && !dest_full)
+        {
+            // a line longer than the scratch buffer can't be evaluated, skip
+            // it entirely
+            consumed = chunk;
+            skip_to_newline = true;
+        }
+
+        pos += consumed;
+    }
+
+    err = OS_FileSystemFile_close(logFile->log_file_info.hFs,
+                                  hFile);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to close file: %s\n", __func__, filename);
+        return -1;
+    }
+
+    *next_offset = (int64_t)pos;
+
+    return (int64_t)written;
+}
+
+
+
 OS_Error_t
 OS_LoggerFile_ctor(
     OS_LoggerFile_Handle_t* self,
@@ -259,6 +512,188 @@ OS_LoggerFile_create(OS_LoggerFile_Handle_t* self)
 
     self->log_file_info.offset = 0;
 
+    // the log will be overwritten from the beginning, so is its index
+    err = OS_LoggerFileIndex_reset(self);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to reset index of file: %s\n",
+               __func__,
+               self->log_file_info.filename);
+        return err;
+    }
+
+    return OS_SUCCESS;
+}
+
+
+
+static OS_Error_t
+_Log_file_recover(
+    OS_LoggerFile_Handle_t* self,
+    OS_FileSystemFile_Handle_t hFile,
+    uint64_t size)
+{
+    OS_FileSystem_Handle_t hFs = self->log_file_info.hFs;
+    OS_Error_t err;
+
+    const uint64_t window = (size < OS_Logger_FILE_RECOVERY_WINDOW) ?
+                            size : OS_Logger_FILE_RECOVERY_WINDOW;
+
+    // search the last newline backward from the end of the file, only the
+    // window at the end is read, independent of the file size
+    uint64_t end = size;
+    uint64_t line_end = size;
+    bool found = false;
+
+    while (!found && (end > size - window))
+    {
+        size_t chunk = sizeof(file_chunk);
+        if (end - (size - window) < chunk)
+        {
+            chunk = (size_t)(end - (size - window));
+        }
+
+        err = OS_FileSystemFile_read(hFs,
+                                     hFile,
+                                     (size_t)(end - chunk),
+                                     chunk,
+                                     file_chunk);
+        if (OS_SUCCESS != err)
+        {
+            return err;
+        }
+
+        for (size_t i = chunk; i > 0; i--)
+        {
+            if (file_chunk[i - 1] == '\n')
+            {
+                line_end = end - chunk + i;
+                found = true;
+                break;
+            }
+        }
+
+        end -= chunk;
+    }
+
+    if (found && (line_end == size))
+    {
+        // the last line is complete
+        self->log_file_info.offset = size;
+        return OS_SUCCESS;
+    }
+
+    if (!found && (window < size))
+    {
+        // no line is that long, just terminate whatever is there
+        err = OS_FileSystemFile_write(hFs, hFile, (size_t)size, 1, "\n");
+        if (OS_SUCCESS != err)
+        {
+            return err;
+        }
+
+        self->log_file_info.offset = size + 1;
+        return OS_SUCCESS;
+    }
+
+    // blank out the torn last line, so it reads as an empty line
+    const uint64_t torn_begin = found ? line_end : 0;
+    uint64_t pos = torn_begin;
+
+    memset(file_chunk, ' ', sizeof(file_chunk));
+
+    while (pos < size)
+    {
+        size_t chunk = sizeof(file_chunk);
+        if (size - pos < chunk)
+        {
+            chunk = (size_t)(size - pos);
+        }
+
+        if (pos + chunk == size)
+        {
+            file_chunk[chunk - 1] = '\n';
+        }
+
+        err = OS_FileSystemFile_write(hFs, hFile, (size_t)pos, chunk, file_chunk);
+        if (OS_SUCCESS != err)
+        {
+            return err;
+        }
+
+        pos += chunk;
+    }
+
+    printf("%s(): recovered torn last line of %s at offset %" PRIu64 "\n",
+           __func__,
+           self->log_file_info.filename,
+           torn_begin);
+
+    self->log_file_info.offset = size;
+
+    return OS_SUCCESS;
+}
+
+
+
+OS_Error_t
+OS_LoggerFile_append(OS_LoggerFile_Handle_t* self)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    OS_FileSystemFile_Handle_t hFile;
+
+    OS_Error_t err = OS_FileSystemFile_open(self->log_file_info.hFs,
+                                            &hFile,
+                                            self->log_file_info.filename,
+                                            OS_FileSystem_OpenMode_RDWR,
+                                            OS_FileSystem_OpenFlags_CREATE);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to open file: %s\n",
+               __func__,
+               self->log_file_info.filename);
+        return OS_ERROR_INVALID_HANDLE;
+    }
+
+    off_t sz;
+    err = OS_FileSystemFile_getSize(self->log_file_info.hFs,
+                                    self->log_file_info.filename,
+                                    &sz);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to get size of file: %s\n",
+               __func__,
+               self->log_file_info.filename);
+        OS_FileSystemFile_close(self->log_file_info.hFs, hFile);
+        return err;
+    }
+
+    self->log_file_info.offset = 0;
+
+    if (sz > 0)
+    {
+        err = _Log_file_recover(self, hFile, (uint64_t)sz);
+        if (OS_SUCCESS != err)
+        {
+            printf("%s(): ERROR: failed to recover file: %s\n",
+                   __func__,
+                   self->log_file_info.filename);
+            OS_FileSystemFile_close(self->log_file_info.hFs, hFile);
+            return err;
+        }
+    }
+
+    err = OS_FileSystemFile_close(self->log_file_info.hFs,
+                                  hFile);
+    if (OS_SUCCESS != err)
+    {
+        printf("%s(): ERROR: failed to close file: %s\n",
+               __func__,
+               self->log_file_info.filename);
+        return err;
+    }
+
     return OS_SUCCESS;
 }
 
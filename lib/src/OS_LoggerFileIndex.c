@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Logger/Server/OS_LoggerFileIndex.h"
+#include <string.h>
+#include <stdio.h>
+
+#define INDEX_FILENAME_SIZE \
+    (sizeof(((OS_LoggerFile_Handle_t*)0)->log_file_info.filename) \
+     + sizeof(OS_Logger_FILE_INDEX_SUFFIX))
+
+
+
+static void
+_get_index_filename(OS_LoggerFile_Handle_t* log_file, char* filename)
+{
+    snprintf(
+        filename,
+        INDEX_FILENAME_SIZE,
+        "%s%s",
+        log_file->log_file_info.filename,
+        OS_Logger_FILE_INDEX_SUFFIX);
+}
+
+static OS_Error_t
+_read_record(
+    OS_FileSystem_Handle_t hFs,
+    OS_FileSystemFile_Handle_t hFile,
+    uint64_t pos,
+    OS_LoggerFileIndex_Record_t* record)
+{
+    return OS_FileSystemFile_read(
+               hFs,
+               hFile,
+               (size_t)(pos * sizeof(OS_LoggerFileIndex_Record_t)),
+               sizeof(OS_LoggerFileIndex_Record_t),
+               record);
+}
+
+
+
+OS_Error_t
+OS_LoggerFileIndex_reset(OS_LoggerFile_Handle_t* log_file)
+{
+    OS_Logger_CHECK_SELF(log_file);
+
+    char filename[INDEX_FILENAME_SIZE];
+    _get_index_filename(log_file, filename);
+
+    off_t sz;
+    if (OS_FileSystemFile_getSize(log_file->log_file_info.hFs, filename, &sz)
+        != OS_SUCCESS)
+    {
+        // no index exists yet
+        return OS_SUCCESS;
+    }
+
+    return OS_FileSystemFile_delete(log_file->log_file_info.hFs, filename);
+}
+
+
+
+OS_Error_t
+OS_LoggerFileIndex_update(
+    OS_LoggerFile_Handle_t* log_file,
+    uint64_t offset,
+    uint64_t len,
+    uint64_t timestamp)
+{
+    OS_Logger_CHECK_SELF(log_file);
+
+    // only the first line and the lines reaching into a new stride are indexed
+    if ((offset != 0)
+        && ((offset / OS_Logger_FILE_INDEX_STRIDE)
+            == ((offset + len) / OS_Logger_FILE_INDEX_STRIDE)))
+    {
+        return OS_SUCCESS;
+    }
+
+    char filename[INDEX_FILENAME_SIZE];
+    _get_index_filename(log_file, filename);
+
+    OS_FileSystem_Handle_t hFs = log_file->log_file_info.hFs;
+    OS_FileSystemFile_Handle_t hFile;
+
+    off_t sz;
+    if (OS_FileSystemFile_getSize(hFs, filename, &sz) != OS_SUCCESS)
+    {
+        sz = 0;
+    }
+
+    OS_Error_t err = OS_FileSystemFile_open(hFs,
+                                            &hFile,
+                                            filename,
+                                            OS_FileSystem_OpenMode_WRONLY,
+                                            OS_FileSystem_OpenFlags_CREATE);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to open file: %s!\n", filename);
+        return err;
+    }
+
+    const OS_LoggerFileIndex_Record_t record =
+    {
+        .timestamp  = timestamp,
+        .offset     = offset
+    };
+
+    // drop a partially written record
+    sz -= sz % (off_t)sizeof(record);
+
+    err = OS_FileSystemFile_write(hFs,
+                                  hFile,
+                                  (size_t)sz,
+                                  sizeof(record),
+                                  &record);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to write file: %s!\n", filename);
+        OS_FileSystemFile_close(hFs, hFile);
+        return err;
+    }
+
+    err = OS_FileSystemFile_close(hFs, hFile);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to close file: %s!\n", filename);
+        return err;
+    }
+
+    return OS_SUCCESS;
+}
+
+
+
+OS_Error_t
+OS_LoggerFileIndex_seek(
+    OS_LoggerFile_Handle_t* log_file,
+    uint64_t timestamp,
+    uint64_t* offset)
+{
+    OS_Logger_CHECK_SELF(log_file);
+
+    if (offset == NULL)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    *offset = 0;
+
+    char filename[INDEX_FILENAME_SIZE];
+    _get_index_filename(log_file, filename);
+
+    OS_FileSystem_Handle_t hFs = log_file->log_file_info.hFs;
+    OS_FileSystemFile_Handle_t hFile;
+
+    off_t sz;
+    if (OS_FileSystemFile_getSize(hFs, filename, &sz) != OS_SUCCESS)
+    {
+        // without an index the log has to be read from the beginning
+        return OS_SUCCESS;
+    }
+
+    uint64_t count = (uint64_t)sz / sizeof(OS_LoggerFileIndex_Record_t);
+    if (count == 0)
+    {
+        return OS_SUCCESS;
+    }
+
+    OS_Error_t err = OS_FileSystemFile_open(hFs,
+                                            &hFile,
+                                            filename,
+                                            OS_FileSystem_OpenMode_RDONLY,
+                                            OS_FileSystem_OpenFlags_NONE);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to open file: %s!\n", filename);
+        return err;
+    }
+
+    // find the last record with a timestamp strictly below the requested one,
+    // entries of that very second may be located before the next record
+    uint64_t lo = 0;
+    uint64_t hi = count;
+    OS_LoggerFileIndex_Record_t record;
+
+    while (lo < hi)
+    {
+        const uint64_t mid = lo + (hi - lo) / 2;
+
+        err = _read_record(hFs, hFile, mid, &record);
+        if (OS_SUCCESS != err)
+        {
+            printf("Fail to read file: %s!\n", filename);
+            OS_FileSystemFile_close(hFs, hFile);
+            return err;
+        }
+
+        if (record.timestamp < timestamp)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if (lo > 0)
+    {
+        err = _read_record(hFs, hFile, lo - 1, &record);
+        if (OS_SUCCESS != err)
+        {
+            printf("Fail to read file: %s!\n", filename);
+            OS_FileSystemFile_close(hFs, hFile);
+            return err;
+        }
+
+        *offset = record.offset;
+    }
+
+    // a buffered output indexes entries before they reach the log file
+    off_t log_sz;
+    if ((OS_FileSystemFile_getSize(hFs, log_file->log_file_info.filename,
+                                   &log_sz) == OS_SUCCESS)
+        && (*offset > (uint64_t)log_sz))
+    {
+        *offset = (uint64_t)log_sz;
+    }
+
+    err = OS_FileSystemFile_close(hFs, hFile);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to close file: %s!\n", filename);
+        return err;
+    }
+
+    return OS_SUCCESS;
+}
@@ -7,7 +7,7 @@
  */
 
 #include "Logger/Server/OS_LoggerFormat.h"
-#include "Logger/Server/OS_LoggerTimestamp.h"
+#include "Logger/Server/OS_LoggerFormatRender.h"
 #include <stdio.h>
 
 // forward declaration
@@ -41,37 +41,13 @@ _Log_format_convert(
         return OS_ERROR_INVALID_PARAMETER;
     }
 
-    OS_LoggerTimestamp_Handle_t* const timestamp =
-        OS_LoggerTimestamp_getInstance();
-
-    timestamp->timestamp = entry->consumerMetadata.timestamp;
-
-    OS_LoggerTime_Handle_t tm;
-    OS_LoggerTimestamp_getTime(timestamp, 0, &tm);
-
-    size_t msg_len = strlen(entry->msg);
-
-    if (msg_len > OS_Logger_ENTRY_MESSAGE_LENGTH)
-    {
-        msg_len = OS_Logger_ENTRY_MESSAGE_LENGTH;
-    }
-
     OS_LoggerFormat_Handle_t* const log_format =
         (OS_LoggerFormat_Handle_t*)self;
 
-    sprintf(
+    OS_LoggerFormatRender_default(
+        entry,
         log_format->buffer,
-        "%.*u %-*s %02d.%02d.%04d-%02d:%02d:%02d %*u %*u %.*s\n",
-
-        OS_Logger_ID_LENGTH, entry->consumerMetadata.id,
-        OS_Logger_NAME_LENGTH, entry->consumerMetadata.name,
-
-        tm.day, tm.month, tm.year, tm.hour, tm.min, tm.sec,
-
-        OS_Logger_LOG_LEVEL_LENGTH, entry->emitterMetadata.filteringLevel,
-        OS_Logger_LOG_LEVEL_LENGTH, entry->consumerMetadata.filteringLevel,
-
-        (int)msg_len, entry->msg);
+        sizeof(log_format->buffer));
 
     return OS_SUCCESS;
 }
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Logger/Server/OS_LoggerFormatRender.h"
+#include "Logger/Server/OS_LoggerTimestamp.h"
+#include <stdio.h>
+#include <string.h>
+
+size_t
+OS_LoggerFormatRender_default(
+    OS_LoggerEntry_t const* const entry,
+    char* buf,
+    size_t size)
+{
+    if (NULL == entry || NULL == buf || 0 == size)
+    {
+        return 0;
+    }
+
+    // a local handle instead of the singleton keeps rendering reentrant
+    OS_LoggerTimestamp_Handle_t timestamp =
+    {
+        .timestamp = entry->consumerMetadata.timestamp
+    };
+
+    OS_LoggerTime_Handle_t tm;
+    OS_LoggerTimestamp_getTime(&timestamp, 0, &tm);
+
+    // never scan beyond the message, even if it isn't null-terminated
+    const size_t msg_len = strnlen(entry->msg, OS_Logger_ENTRY_MESSAGE_LENGTH);
+
+    const int len = snprintf(
+                        buf,
+                        size,
+                        "%.*u %-*s %02d.%02d.%04d-%02d:%02d:%02d %*u %*u %.*s\n",
+
+                        OS_Logger_ID_LENGTH, entry->consumerMetadata.id,
+                        OS_Logger_NAME_LENGTH, entry->consumerMetadata.name,
+
+                        tm.day, tm.month, tm.year, tm.hour, tm.min, tm.sec,
+
+                        OS_Logger_LOG_LEVEL_LENGTH,
+                        entry->emitterMetadata.filteringLevel,
+                        OS_Logger_LOG_LEVEL_LENGTH,
+                        entry->consumerMetadata.filteringLevel,
+
+                        (int)msg_len, entry->msg);
+
+    return (len < 0) ? 0 : (size_t)len;
+}
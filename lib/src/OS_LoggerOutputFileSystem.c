@@ -9,6 +9,7 @@
 #include "Logger/Server/OS_LoggerOutputFileSystem.h"
 #include "Logger/Server/OS_LoggerConsumer.h"
 #include "Logger/Server/OS_LoggerFile.h"
+#include "Logger/Server/OS_LoggerFileIndex.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -44,6 +45,8 @@ update(
     OS_LoggerFile_Handle_t* logFile = (OS_LoggerFile_Handle_t*)
                                       log_consumer->log_file;
 
+    const size_t len = strlen(self->logFormat->buffer);
+
     OS_Error_t err = OS_FileSystemFile_open(logFile->log_file_info.hFs,
                                             &hFile,
                                             logFile->log_file_info.filename,
@@ -58,7 +61,7 @@ update(
     err = OS_FileSystemFile_write(logFile->log_file_info.hFs,
                                   hFile,
                                   logFile->log_file_info.offset,
-                                  (size_t)strlen(self->logFormat->buffer),
+                                  len,
                                   self->logFormat->buffer);
     if (OS_SUCCESS != err)
     {
@@ -73,7 +76,20 @@ update(
         return err;
     }
 
-    logFile->log_file_info.offset += strlen(self->logFormat->buffer);
+    err = OS_LoggerFileIndex_update(
+              logFile,
+              logFile->log_file_info.offset,
+              len,
+              log_consumer->entry->consumerMetadata.timestamp);
+    if (OS_SUCCESS != err)
+    {
+        // the log itself has been written, a missing index record only makes
+        // seeking less precise
+        printf("Fail to update index of file: %s!\n",
+               logFile->log_file_info.filename);
+    }
+
+    logFile->log_file_info.offset += len;
 
     return OS_SUCCESS;
 }
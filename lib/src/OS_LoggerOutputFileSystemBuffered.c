@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Logger/Server/OS_LoggerOutputFileSystemBuffered.h"
+#include "Logger/Server/OS_LoggerConsumer.h"
+#include "Logger/Server/OS_LoggerFileIndex.h"
+#include <string.h>
+#include <stdio.h>
+
+
+
+static OS_Error_t
+_write(
+    OS_LoggerFile_Handle_t* logFile,
+    const char* data,
+    size_t len)
+{
+    OS_FileSystemFile_Handle_t hFile;
+
+    OS_Error_t err = OS_FileSystemFile_open(logFile->log_file_info.hFs,
+                                            &hFile,
+                                            logFile->log_file_info.filename,
+                                            OS_FileSystem_OpenMode_WRONLY,
+                                            OS_FileSystem_OpenFlags_NONE);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to open file: %s!\n", logFile->log_file_info.filename);
+        return OS_ERROR_INVALID_HANDLE;
+    }
+
+    err = OS_FileSystemFile_write(logFile->log_file_info.hFs,
+                                  hFile,
+                                  logFile->log_file_info.offset,
+                                  len,
+                                  data);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to write file: %s!\n", logFile->log_file_info.filename);
+        OS_FileSystemFile_close(logFile->log_file_info.hFs, hFile);
+        return err;
+    }
+
+    err = OS_FileSystemFile_close(logFile->log_file_info.hFs, hFile);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to close file: %s!\n", logFile->log_file_info.filename);
+        return err;
+    }
+
+    logFile->log_file_info.offset += len;
+
+    return OS_SUCCESS;
+}
+
+
+
+OS_Error_t
+OS_LoggerOutputFileSystemBuffered_flush(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    if (self->used == 0)
+    {
+        return OS_SUCCESS;
+    }
+
+    const OS_Error_t err = _write(self->log_file, self->buffer, self->used);
+
+    // on failure the pending entries are dropped, retrying them would only
+    // block the critical lane
+    self->used = 0;
+    self->pending_entries = 0;
+    self->sync_count++;
+
+    return err;
+}
+
+
+
+static OS_Error_t
+update(
+    OS_LoggerOutput_Handle_t* output,
+    void* data)
+{
+    OS_Logger_CHECK_SELF(output);
+
+    if (data == NULL)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self =
+        (OS_LoggerOutputFileSystemBuffered_Handle_t*)output;
+    OS_LoggerConsumer_Handle_t* log_consumer =
+        (OS_LoggerConsumer_Handle_t*)data;
+
+    // check if log_file is installed
+    if (log_consumer->log_file == NULL)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    OS_LoggerFile_Handle_t* logFile = (OS_LoggerFile_Handle_t*)
+                                      log_consumer->log_file;
+
+    OS_LoggerEntry_t const* const entry = log_consumer->entry;
+    OS_Error_t err;
+
+    // pending entries of another log file
+    if ((self->used > 0) && (self->log_file != logFile))
+    {
+        err = OS_LoggerOutputFileSystemBuffered_flush(self);
+        if (OS_SUCCESS != err)
+        {
+            return err;
+        }
+    }
+
+    self->log_file = logFile;
+
+    const char* line = NULL;
+    size_t len = 0;
+
+    if (self->render != NULL)
+    {
+        // render straight into the batch buffer, the line fits only if there
+        // is space left for the null-terminator as well
+        len = self->render(entry,
+                           &self->buffer[self->used],
+                           self->size - self->used);
+
+        if ((len >= self->size - self->used) && (self->used > 0))
+        {
+            err = OS_LoggerOutputFileSystemBuffered_flush(self);
+            if (OS_SUCCESS != err)
+            {
+                return err;
+            }
+
+            len = self->render(entry, self->buffer, self->size);
+        }
+
+        if (len < self->size - self->used)
+        {
+            line = &self->buffer[self->used];
+        }
+    }
+
+    if (line == NULL)
+    {
+        // log format layer
+        output->logFormat->vtable->convert(
+            (OS_LoggerAbstractFormat_Handle_t*)output->logFormat,
+            entry);
+
+        len = strlen(output->logFormat->buffer);
+
+        if ((self->used > 0) && (self->used + len > self->size))
+        {
+            err = OS_LoggerOutputFileSystemBuffered_flush(self);
+            if (OS_SUCCESS != err)
+            {
+                return err;
+            }
+        }
+    }
+
+    err = OS_LoggerFileIndex_update(
+              logFile,
+              logFile->log_file_info.offset + self->used,
+              len,
+              entry->consumerMetadata.timestamp);
+    if (OS_SUCCESS != err)
+    {
+        printf("Fail to update index of file: %s!\n",
+               logFile->log_file_info.filename);
+    }
+
+    if (line == NULL)
+    {
+        if (len > self->size)
+        {
+            // doesn't fit into the bulk lane at all
+            self->sync_count++;
+            return _write(logFile, output->logFormat->buffer, len);
+        }
+
+        memcpy(&self->buffer[self->used], output->logFormat->buffer, len);
+    }
+
+    if (self->pending_entries == 0)
+    {
+        self->pending_since = entry->consumerMetadata.timestamp;
+    }
+
+    self->used += len;
+    self->pending_entries++;
+
+    const OS_LoggerDurability_t* const durability = &self->durability;
+
+    if ((entry->emitterMetadata.level <= durability->sync_level)
+        || ((durability->sync_entries != 0)
+            && (self->pending_entries >= durability->sync_entries))
+        || ((durability->sync_interval != 0)
+            && (entry->consumerMetadata.timestamp
+                >= self->pending_since + durability->sync_interval)))
+    {
+        return OS_LoggerOutputFileSystemBuffered_flush(self);
+    }
+
+    return OS_SUCCESS;
+}
+
+
+
+OS_Error_t
+OS_LoggerOutputFileSystemBuffered_ctor(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self,
+    OS_LoggerFormat_Handle_t* logFormat,
+    void* buffer,
+    size_t size,
+    uint8_t critical_level)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    if (buffer == NULL || size == 0)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    self->log_file          = NULL;
+    self->render            = NULL;
+    self->buffer            = (char*)buffer;
+    self->size              = size;
+    self->used              = 0;
+    self->pending_entries   = 0;
+    self->pending_since     = 0;
+    self->sync_count        = 0;
+
+    memset(&self->durability, 0, sizeof(self->durability));
+    self->durability.sync_level = critical_level;
+
+    return OS_LoggerOutput_ctor(&self->output, logFormat, update);
+}
+
+
+
+void
+OS_LoggerOutputFileSystemBuffered_setRender(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self,
+    OS_LoggerFormatRender_t render)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    self->render = render;
+}
+
+
+
+void
+OS_LoggerOutputFileSystemBuffered_setDurability(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self,
+    OS_LoggerDurability_t const* durability)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    if (durability == NULL)
+    {
+        return;
+    }
+
+    self->durability = *durability;
+}
+
+
+
+uint32_t
+OS_LoggerOutputFileSystemBuffered_getSyncCount(
+    OS_LoggerOutputFileSystemBuffered_Handle_t* self)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    return self->sync_count;
+}
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Logger/Common/OS_LoggerQuery.h"
+#include "Logger/Server/OS_LoggerTimestamp.h"
+#include <string.h>
+
+// "dd.mm.yyyy-hh:mm:ss" as rendered by OS_LoggerFormat
+#define DATE_LENGTH             19
+
+typedef struct
+{
+    uint32_t    id;
+    const char* name;
+    uint64_t    timestamp;
+    uint32_t    emitter_filtering_level;
+    uint32_t    consumer_filtering_level;
+    const char* msg;
+    size_t      msg_len;
+} Log_query_line_t;
+
+// forward declaration
+static bool _parse_line(
+    const char* line,
+    size_t len,
+    Log_query_line_t* parsed);
+
+
+
+void
+OS_LoggerQuery_ctor(OS_LoggerQuery_t* self)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    memset(self, 0, sizeof(OS_LoggerQuery_t));
+}
+
+OS_Error_t
+OS_LoggerQuery_setPattern(OS_LoggerQuery_t* self, const char* pattern)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    if (pattern == NULL)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    const size_t len = strlen(pattern);
+
+    if (len == 0 || len > OS_Logger_QUERY_PATTERN_LENGTH)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    memcpy(self->pattern, pattern, len + 1);
+    self->pattern_len = (uint32_t)len;
+    self->flags |= OS_LoggerQuery_MATCH_PATTERN;
+
+    return OS_SUCCESS;
+}
+
+
+
+const char*
+OS_LoggerQuery_findSubstring(
+    const char* haystack,
+    size_t haystack_len,
+    const char* needle,
+    size_t needle_len)
+{
+    if (haystack == NULL || needle == NULL || needle_len > haystack_len)
+    {
+        return NULL;
+    }
+
+    if (needle_len == 0)
+    {
+        return haystack;
+    }
+
+    const char* pos = haystack;
+    const char* const last = haystack + (haystack_len - needle_len);
+
+    while (pos <= last)
+    {
+        pos = memchr(pos, needle[0], (size_t)(last - pos) + 1);
+        if (pos == NULL)
+        {
+            return NULL;
+        }
+
+        if (0 == memcmp(pos + 1, needle + 1, needle_len - 1))
+        {
+            return pos;
+        }
+
+        pos++;
+    }
+
+    return NULL;
+}
+
+
+
+static bool
+_parse_digits(const char* str, size_t count, uint32_t* val)
+{
+    uint32_t tmp = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+        {
+            return false;
+        }
+
+        tmp = tmp * 10 + (uint32_t)(str[i] - '0');
+    }
+
+    *val = tmp;
+
+    return true;
+}
+
+static bool
+_parse_date(const char* str, uint64_t* timestamp)
+{
+    uint32_t day, month, year, hour, min, sec;
+
+    if (!_parse_digits(&str[0], 2, &day)
+        || !_parse_digits(&str[3], 2, &month)
+        || !_parse_digits(&str[6], 4, &year)
+        || !_parse_digits(&str[11], 2, &hour)
+        || !_parse_digits(&str[14], 2, &min)
+        || !_parse_digits(&str[17], 2, &sec))
+    {
+        return false;
+    }
+
+    if (month < 1 || month > 12)
+    {
+        return false;
+    }
+
+    OS_LoggerTime_Handle_t tm =
+    {
+        .sec    = (uint8_t)sec,
+        .min    = (uint8_t)min,
+        .hour   = (uint8_t)hour,
+        .day    = (uint8_t)day,
+        .month  = (uint8_t)month,
+        .year   = (uint16_t)year
+    };
+
+    OS_LoggerTimestamp_Handle_t t_stamp;
+
+    // OS_LoggerTimestamp_getTimestamp() requires the singleton to exist
+    OS_LoggerTimestamp_getInstance();
+
+    if (OS_LoggerTimestamp_getTimestamp(&tm, &t_stamp) != OS_SUCCESS)
+    {
+        return false;
+    }
+
+    *timestamp = t_stamp.timestamp;
+
+    return true;
+}
+
+static bool
+_parse_line(const char* line, size_t len, Log_query_line_t* parsed)
+{
+    const char* const end = line + len;
+    const char* pos = line;
+    uint32_t id = 0;
+
+    // consumer id
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+        id = id * 10 + (uint32_t)(*pos - '0');
+        pos++;
+    }
+
+    if (pos == line)
+    {
+        return false;
+    }
+
+    // " <name> " of fixed width
+    parsed->name = pos + 1;
+    pos += 1 + OS_Logger_NAME_LENGTH + 1;
+
+    if (pos + DATE_LENGTH > end)
+    {
+        return false;
+    }
+
+    if (!_parse_date(pos, &parsed->timestamp))
+    {
+        return false;
+    }
+
+    pos += DATE_LENGTH;
+
+    // emitter and consumer filtering level
+    uint32_t* const levels[] =
+    {
+        &parsed->emitter_filtering_level,
+        &parsed->consumer_filtering_level
+    };
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        *levels[i] = 0;
+
+        while (pos < end && *pos == ' ')
+        {
+            pos++;
+        }
+        while (pos < end && *pos >= '0' && *pos <= '9')
+        {
+            *levels[i] = *levels[i] * 10 + (uint32_t)(*pos - '0');
+            pos++;
+        }
+    }
+
+    if (pos < end)
+    {
+        pos++;
+    }
+
+    parsed->id      = id;
+    parsed->msg     = pos;
+    parsed->msg_len = (size_t)(end - pos);
+
+    return true;
+}
+
+
+
+bool
+OS_LoggerQuery_matchLine(
+    const OS_LoggerQuery_t* self,
+    const char* line,
+    size_t len)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    if (line == NULL)
+    {
+        return false;
+    }
+
+    if (self->flags == 0)
+    {
+        return true;
+    }
+
+    Log_query_line_t parsed;
+
+    if (!_parse_line(line, len, &parsed))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_CONSUMER_ID)
+        && (parsed.id != self->consumer_id))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_TIME_FROM)
+        && (parsed.timestamp < self->timestamp_from))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_TIME_TO)
+        && (parsed.timestamp > self->timestamp_to))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_PATTERN)
+        && (NULL == OS_LoggerQuery_findSubstring(
+                parsed.msg,
+                parsed.msg_len,
+                self->pattern,
+                self->pattern_len)))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+
+OS_Error_t
+OS_LoggerQuery_parseLine(
+    const char* line,
+    size_t len,
+    OS_LoggerEntry_t* entry)
+{
+    if (line == NULL || entry == NULL)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    Log_query_line_t parsed;
+
+    if (!_parse_line(line, len, &parsed))
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    memset(&entry->consumerMetadata, 0, sizeof(entry->consumerMetadata));
+    memset(&entry->emitterMetadata, 0, sizeof(entry->emitterMetadata));
+
+    entry->consumerMetadata.id              = parsed.id;
+    entry->consumerMetadata.timestamp       = parsed.timestamp;
+    entry->consumerMetadata.filteringLevel  =
+        (uint8_t)parsed.consumer_filtering_level;
+    entry->emitterMetadata.filteringLevel   =
+        (uint8_t)parsed.emitter_filtering_level;
+
+    // the name is padded with blanks
+    size_t name_len = OS_Logger_NAME_LENGTH;
+    while (name_len > 0 && parsed.name[name_len - 1] == ' ')
+    {
+        name_len--;
+    }
+
+    memcpy(entry->consumerMetadata.name, parsed.name, name_len);
+    entry->consumerMetadata.name[name_len] = '\0';
+
+    size_t msg_len = parsed.msg_len;
+    if (msg_len > OS_Logger_ENTRY_MESSAGE_LENGTH)
+    {
+        msg_len = OS_Logger_ENTRY_MESSAGE_LENGTH;
+    }
+
+    memcpy(entry->msg, parsed.msg, msg_len);
+    entry->msg[msg_len] = '\0';
+
+    return OS_SUCCESS;
+}
+
+
+
+bool
+OS_LoggerQuery_matchEntry(
+    const OS_LoggerQuery_t* self,
+    OS_LoggerEntry_t const* entry)
+{
+    OS_Logger_CHECK_SELF(self);
+
+    if (entry == NULL)
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_CONSUMER_ID)
+        && (entry->consumerMetadata.id != self->consumer_id))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_TIME_FROM)
+        && (entry->consumerMetadata.timestamp < self->timestamp_from))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_TIME_TO)
+        && (entry->consumerMetadata.timestamp > self->timestamp_to))
+    {
+        return false;
+    }
+
+    if ((self->flags & OS_LoggerQuery_MATCH_PATTERN)
+        && (NULL == OS_LoggerQuery_findSubstring(
+                entry->msg,
+                strnlen(entry->msg, OS_Logger_ENTRY_MESSAGE_LENGTH),
+                self->pattern,
+                self->pattern_len)))
+    {
+        return false;
+    }
+
+    return true;
+}
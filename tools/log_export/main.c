@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2020-2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/*
+ * Host tool that decodes, filters and renders log files pulled off a device.
+ *
+ * Each file is memory-mapped and split into chunks at line boundaries. The
+ * chunks are processed in parallel, one round of chunks per set of worker
+ * threads, and the results are written in file order. Rendering uses the same
+ * code as the log server, so the text output is identical to the one on the
+ * device.
+ */
+
+#include "Logger/Common/OS_LoggerQuery.h"
+#include "Logger/Server/OS_LoggerFormatRender.h"
+#include "Logger/Server/OS_LoggerTimestamp.h"
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CHUNK_SIZE          (16 * 1024 * 1024)
+#define MAX_LINE_LENGTH     (OS_Logger_ENTRY_MESSAGE_LENGTH + 256)
+#define MAX_THREADS         256
+
+typedef enum
+{
+    EXPORT_FORMAT_TEXT,
+    EXPORT_FORMAT_CSV
+} Export_format_t;
+
+typedef struct
+{
+    OS_LoggerQuery_t    query;
+    Export_format_t     format;
+    unsigned int        threads;
+} Export_config_t;
+
+typedef struct
+{
+    const Export_config_t*  config;
+    const char*             begin;
+    const char*             end;
+    char*                   out;
+    size_t                  out_len;
+    size_t                  out_size;
+    uint64_t                lines;
+    uint64_t                matched;
+    uint64_t                invalid;
+} Export_job_t;
+
+
+
+static int
+_reserve(Export_job_t* job, size_t len)
+{
+    if (job->out_len + len <= job->out_size)
+    {
+        return 0;
+    }
+
+    size_t size = (job->out_size == 0) ? CHUNK_SIZE : job->out_size;
+    while (size < job->out_len + len)
+    {
+        size *= 2;
+    }
+
+    char* out = realloc(job->out, size);
+    if (out == NULL)
+    {
+        return -1;
+    }
+
+    job->out = out;
+    job->out_size = size;
+
+    return 0;
+}
+
+static int
+_render_csv(Export_job_t* job, OS_LoggerEntry_t const* entry)
+{
+    // worst case every character of the message is a quote
+    if (_reserve(job, 2 * OS_Logger_ENTRY_MESSAGE_LENGTH + 128) != 0)
+    {
+        return -1;
+    }
+
+    char* out = &job->out[job->out_len];
+
+    out += sprintf(
+               out,
+               "%" PRIu32 ",\"%s\",%" PRIu64 ",%u,%u,\"",
+               entry->consumerMetadata.id,
+               entry->consumerMetadata.name,
+               entry->consumerMetadata.timestamp,
+               entry->emitterMetadata.filteringLevel,
+               entry->consumerMetadata.filteringLevel);
+
+    for (const char* msg = entry->msg; *msg != '\0'; msg++)
+    {
+        if (*msg == '"')
+        {
+            *out++ = '"';
+        }
+        *out++ = *msg;
+    }
+
+    *out++ = '"';
+    *out++ = '\n';
+
+    job->out_len = (size_t)(out - job->out);
+
+    return 0;
+}
+
+static int
+_render_text(Export_job_t* job, OS_LoggerEntry_t const* entry)
+{
+    if (_reserve(job, MAX_LINE_LENGTH) != 0)
+    {
+        return -1;
+    }
+
+    const size_t len = OS_LoggerFormatRender_default(
+                           entry,
+                           &job->out[job->out_len],
+                           job->out_size - job->out_len);
+
+    job->out_len += len;
+
+    return 0;
+}
+
+static void*
+_process(void* arg)
+{
+    Export_job_t* job = (Export_job_t*)arg;
+    OS_LoggerEntry_t entry;
+
+    job->out_len = 0;
+
+    for (const char* line = job->begin; line < job->end; )
+    {
+        const char* nl = memchr(line, '\n', (size_t)(job->end - line));
+        const char* line_end = (nl != NULL) ? nl : job->end;
+
+        job->lines++;
+
+        if (OS_LoggerQuery_parseLine(
+                line,
+                (size_t)(line_end - line),
+                &entry) != OS_SUCCESS)
+        {
+            job->invalid++;
+        }
+        else if (OS_LoggerQuery_matchEntry(&job->config->query, &entry))
+        {
+            job->matched++;
+
+            const int ret = (job->config->format == EXPORT_FORMAT_CSV) ?
+                            _render_csv(job, &entry) :
+                            _render_text(job, &entry);
+            if (ret != 0)
+            {
+                fprintf(stderr, "out of memory\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        line = line_end + 1;
+    }
+
+    return NULL;
+}
+
+static int
+_export_file(
+    const Export_config_t* config,
+    Export_job_t* jobs,
+    const char* filename)
+{
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        perror(filename);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        perror(filename);
+        close(fd);
+        return -1;
+    }
+
+    const size_t size = (size_t)st.st_size;
+    if (size == 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    const char* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        perror(filename);
+        return -1;
+    }
+
+    madvise((void*)data, size, MADV_SEQUENTIAL);
+
+    pthread_t threads[MAX_THREADS];
+    size_t pos = 0;
+
+    while (pos < size)
+    {
+        unsigned int count = 0;
+
+        // split the next round into chunks ending at a line boundary
+        for (; count < config->threads && pos < size; count++)
+        {
+            size_t end = (size - pos > CHUNK_SIZE) ? pos + CHUNK_SIZE : size;
+
+            if (end < size)
+            {
+                const char* nl = memchr(&data[end], '\n', size - end);
+                end = (nl != NULL) ? (size_t)(nl - data) + 1 : size;
+            }
+
+            jobs[count].begin = &data[pos];
+            jobs[count].end = &data[end];
+
+            pos = end;
+        }
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (pthread_create(&threads[i], NULL, _process, &jobs[i]) != 0)
+            {
+                // fall back to process the chunk in this thread
+                _process(&jobs[i]);
+                threads[i] = pthread_self();
+            }
+        }
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (!pthread_equal(threads[i], pthread_self()))
+            {
+                pthread_join(threads[i], NULL);
+            }
+
+            fwrite(jobs[i].out, 1, jobs[i].out_len, stdout);
+        }
+    }
+
+    munmap((void*)data, size);
+
+    return 0;
+}
+
+static void
+_usage(const char* name)
+{
+    fprintf(stderr,
+            "usage: %s [options] file...\n"
+            "  -j <threads>   number of worker threads (default: all cores)\n"
+            "  -i <id>        only entries of the given consumer id\n"
+            "  -s <string>    only entries whose message contains string\n"
+            "  -f <seconds>   only entries at or after the given timestamp\n"
+            "  -t <seconds>   only entries at or before the given timestamp\n"
+            "  -c             render CSV instead of the log server's layout\n",
+            name);
+}
+
+int
+main(int argc, char* argv[])
+{
+    Export_config_t config;
+    int opt;
+
+    OS_LoggerQuery_ctor(&config.query);
+    config.format = EXPORT_FORMAT_TEXT;
+
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    config.threads = (cores > 0) ? (unsigned int)cores : 1;
+
+    while ((opt = getopt(argc, argv, "j:i:s:f:t:c")) != -1)
+    {
+        switch (opt)
+        {
+        case 'j':
+            config.threads = (unsigned int)strtoul(optarg, NULL, 0);
+            break;
+        case 'i':
+            config.query.consumer_id = (uint32_t)strtoul(optarg, NULL, 0);
+            config.query.flags |= OS_LoggerQuery_MATCH_CONSUMER_ID;
+            break;
+        case 's':
+            if (OS_LoggerQuery_setPattern(&config.query, optarg) != OS_SUCCESS)
+            {
+                fprintf(stderr, "invalid search string: %s\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'f':
+            config.query.timestamp_from = strtoull(optarg, NULL, 0);
+            config.query.flags |= OS_LoggerQuery_MATCH_TIME_FROM;
+            break;
+        case 't':
+            config.query.timestamp_to = strtoull(optarg, NULL, 0);
+            config.query.flags |= OS_LoggerQuery_MATCH_TIME_TO;
+            break;
+        case 'c':
+            config.format = EXPORT_FORMAT_CSV;
+            break;
+        default:
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (config.threads == 0)
+    {
+        config.threads = 1;
+    }
+    else if (config.threads > MAX_THREADS)
+    {
+        config.threads = MAX_THREADS;
+    }
+
+    // create the singleton before the workers use the timestamp conversion
+    OS_LoggerTimestamp_getInstance();
+
+    Export_job_t* jobs = calloc(config.threads, sizeof(Export_job_t));
+    if (jobs == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    for (unsigned int i = 0; i < config.threads; i++)
+    {
+        jobs[i].config = &config;
+    }
+
+    int ret = EXIT_SUCCESS;
+
+    for (int i = optind; i < argc; i++)
+    {
+        if (_export_file(&config, jobs, argv[i]) != 0)
+        {
+            ret = EXIT_FAILURE;
+        }
+    }
+
+    uint64_t lines = 0, matched = 0, invalid = 0;
+
+    for (unsigned int i = 0; i < config.threads; i++)
+    {
+        lines += jobs[i].lines;
+        matched += jobs[i].matched;
+        invalid += jobs[i].invalid;
+        free(jobs[i].out);
+    }
+
+    free(jobs);
+
+    fprintf(stderr,
+            "%" PRIu64 " lines, %" PRIu64 " matched, %" PRIu64 " invalid\n",
+            lines,
+            matched,
+            invalid);
+
+    return ret;
+}